@@ -22,6 +22,26 @@ esp_netif_t *esp_netif;
 
 static EventGroupHandle_t wifi_events; // event handler for the WIFI
 
+static esp_netif_t *esp_netif_sta_with_ap = NULL; // STA interface created next to the AP while provisioning
+
+static wifi_status_cb_t wifi_status_callback = NULL; // Callback to report the connection progress
+
+static bool connect_on_sta_start = true;           // STA_START event triggers the connection (false while provisioning, the caller connects)
+static volatile bool disconnect_requested = false; // Disconnect is done by this code: not reported and not retried
+static bool sta_session_active = false;            // Station was asked to connect by wifi_connect_sta_keep_ap()
+static volatile uint8_t last_failure_reason = 0;   // Reason of the last failed connection attempt
+
+/*
+ * Report the connection progress to the registered callback (if any).
+ */
+static void report_wifi_status(WIFI_STATUS_t status, uint8_t reason)
+{
+    if (wifi_status_callback != NULL)
+    {
+        wifi_status_callback(status, reason);
+    }
+}
+
 /*
  * This function is used for the debug purpose. According to the error this return the char string pointer that contain the error message.
  */
@@ -104,14 +124,20 @@ void WIFI_event_handler(void *event_handler_arg, esp_event_base_t event_base, in
     {
     case SYSTEM_EVENT_STA_START: // Connecting to forcefully to the AP network.
     {
-        ESP_LOGI(TAG, "connecting...");
-        esp_wifi_connect(); // Connect the ESP32 WiFi station to the AP network. [configured while start the STA mode]
+        // While provisioning the STA is started by the mode change before its config is set, so the caller connects instead.
+        if (connect_on_sta_start)
+        {
+            ESP_LOGI(TAG, "connecting...");
+            report_wifi_status(WIFI_STATUS_SCANNING, 0);
+            esp_wifi_connect(); // Connect the ESP32 WiFi station to the AP network. [configured while start the STA mode]
+        }
     }
     break;
 
     case SYSTEM_EVENT_STA_CONNECTED: // ESP32 connected successfully to the WIFI network.
     {
         ESP_LOGI(TAG, "connected");
+        report_wifi_status(WIFI_STATUS_ASSOCIATED, 0);
     }
     break;
 
@@ -124,6 +150,13 @@ void WIFI_event_handler(void *event_handler_arg, esp_event_base_t event_base, in
         if (wifi_event_sta_disconnected->reason == WIFI_REASON_ASSOC_LEAVE)
         {
             ESP_LOGI(TAG, "disconnected");
+
+            // The disconnect requested by this code is not news for the portal.
+            if (!disconnect_requested)
+            {
+                report_wifi_status(WIFI_STATUS_DISCONNECTED, wifi_event_sta_disconnected->reason);
+            }
+
             xEventGroupSetBits(wifi_events, ESP32_DISCONNECTED);
             break;
         }
@@ -134,6 +167,16 @@ void WIFI_event_handler(void *event_handler_arg, esp_event_base_t event_base, in
         const char *err = get_error(wifi_event_sta_disconnected->reason);
         ESP_LOGE(TAG, "disconnected: %s", err);
 
+        // The attempt is stopped by this code: keep the reason of the real failure and do not retry.
+        if (disconnect_requested)
+        {
+            xEventGroupSetBits(wifi_events, ESP32_DISCONNECTED);
+            break;
+        }
+
+        last_failure_reason = wifi_event_sta_disconnected->reason;
+        report_wifi_status(WIFI_STATUS_FAILED, wifi_event_sta_disconnected->reason); // Keep the failure on the portal until the next progress
+
         esp_wifi_connect();
         // xEventGroupSetBits(wifi_events, ESP32_DISCONNECTED);
     }
@@ -142,6 +185,7 @@ void WIFI_event_handler(void *event_handler_arg, esp_event_base_t event_base, in
     case IP_EVENT_STA_GOT_IP:
     {
         ESP_LOGI(TAG, "GOT IP");
+        report_wifi_status(WIFI_STATUS_GOT_IP, 0);
         xEventGroupSetBits(wifi_events, ESP32_GOT_IP); // Set the BIT of connection is successful.
     }
     break;
@@ -164,13 +208,19 @@ void WIFI_event_handler(void *event_handler_arg, esp_event_base_t event_base, in
 }
 
 /*
- * This function is for start the WIFI peripheral in the ESP
+ * This function is for start the TCP/IP stack and the default event loop. It does not need the NVS so it can run while the NVS is initialized.
  */
-void wifi_init(void)
+void wifi_init_netif(void)
 {
     ESP_ERROR_CHECK(esp_netif_init());                // Initialize the underlying TCP/IP stack
     ESP_ERROR_CHECK(esp_event_loop_create_default()); // Create default event loop
+}
 
+/*
+ * This function is for start the WIFI driver. The NVS flash and wifi_init_netif() must be done before.
+ */
+void wifi_init_driver(void)
+{
     wifi_init_config_t wifi_init_config = WIFI_INIT_CONFIG_DEFAULT(); //  WiFi stack configuration parameters to the default
 
     /*
@@ -189,6 +239,15 @@ void wifi_init(void)
     ESP_ERROR_CHECK(esp_wifi_set_storage(WIFI_STORAGE_RAM));
 }
 
+/*
+ * This function is for start the WIFI peripheral in the ESP
+ */
+void wifi_init(void)
+{
+    wifi_init_netif();
+    wifi_init_driver();
+}
+
 /*
  * @brief  function is used for the connect the WIFI to the station network.
 
@@ -234,6 +293,105 @@ esp_err_t wifi_connect_sta(const char *ssid, const char *pass, int timeout)
     return function_status;
 }
 
+/*
+ * This function is used for the register the callback which receive the connection progress of the station interface.
+ * Pass NULL to remove the callback.
+ */
+void wifi_register_status_callback(wifi_status_cb_t callback)
+{
+    wifi_status_callback = callback;
+}
+
+/*
+ * This function is used for the stop the current station attempt without reporting it to the portal.
+ * It waits (limited by WIFI_DISCONNECT_TIMEOUT_1_SEC) for the disconnect event, so the event can not arrive in the middle of the next attempt.
+ */
+static void wifi_disconnect_quietly(void)
+{
+    disconnect_requested = true; // Stays set until the next attempt so a late event is not reported either.
+
+    xEventGroupClearBits(wifi_events, ESP32_DISCONNECTED);
+
+    if (esp_wifi_disconnect() == ESP_OK)
+    {
+        xEventGroupWaitBits(wifi_events, ESP32_DISCONNECTED, pdTRUE, pdFALSE, pdMS_TO_TICKS(WIFI_DISCONNECT_TIMEOUT_1_SEC));
+    }
+
+    sta_session_active = false;
+}
+
+/*
+ * @brief  function is used for the connect the WIFI to the station network while the AP stay up.
+ *
+ * This is used from the provisioning portal: the phone stays connected to the ESP32 AP and can watch the progress of the connection.
+ * The STA interface is created only once so the function can be called again when the user submit new credentials.
+ *
+ * @note The ESP32 has one radio, so in APSTA mode the AP moves to the channel of the home router when the station associates.
+ *       If the router is on another channel the phone is dropped from the AP and has to join it again on the new channel.
+ *       The portal page reconnects its WebSocket and the server replays the last status, so the result still reaches the user.
+ *
+ * @param[in] ssid - SSID of the WIFI network over which we have to connect.
+ * @param[in] pass - credentials of the wifi network over which we have to connect.
+ * @param[in] timeout - Time out if the ESP is not able to connect to the WIFI network.
+ *
+ * @return
+ *   - ESP_OK: succeed
+ *   - ESP_FAIL: WiFi is not able to connect with the WIFI network
+ */
+esp_err_t wifi_connect_sta_keep_ap(const char *ssid, const char *pass, int timeout)
+{
+    if (wifi_events == NULL)
+    {
+        wifi_events = xEventGroupCreate(); // Creat the event group for the WIFI sta mode.
+    }
+
+    if (esp_netif_sta_with_ap == NULL)
+    {
+        esp_netif_sta_with_ap = esp_netif_create_default_wifi_sta(); // Creates default WIFI STA next to the AP interface.
+    }
+
+    // Leave the network of the previous attempt (if any) before the new attempt reports its progress.
+    if (sta_session_active)
+    {
+        wifi_disconnect_quietly();
+    }
+
+    disconnect_requested = false;
+    last_failure_reason = 0;
+    xEventGroupClearBits(wifi_events, ESP32_GOT_IP | ESP32_DISCONNECTED);
+
+    wifi_config_t wifi_config;                      // Initialize the variable to hold the credential parameters of the WIFI network.
+    memset(&wifi_config, 0, sizeof(wifi_config_t)); // Set to zero
+
+    strncpy((char *)wifi_config.sta.ssid, ssid, sizeof(wifi_config.sta.ssid) - 1);         // copy the SSID
+    strncpy((char *)wifi_config.sta.password, pass, sizeof(wifi_config.sta.password) - 1); // copy the password
+
+    connect_on_sta_start = false; // The STA_START of the mode change comes before the config, this function does the only connect.
+
+    esp_wifi_set_mode(WIFI_MODE_APSTA);                 // Keep the AP running and enable the station.
+    esp_wifi_set_config(ESP_IF_WIFI_STA, &wifi_config); // Pass the credential parameters of the WIFI network
+
+    report_wifi_status(WIFI_STATUS_SCANNING, 0);
+    esp_wifi_connect(); // The WIFI is already started by the AP so the connection has to be triggered here.
+    sta_session_active = true;
+
+    EventBits_t result = xEventGroupWaitBits(wifi_events, ESP32_GOT_IP, pdTRUE, pdFALSE, pdMS_TO_TICKS(timeout));
+
+    if (result & ESP32_GOT_IP)
+    {
+        return ESP_OK;
+    }
+
+    /*
+     * Stop the retry loop of the event handler and finish the portal with the reason of the last failed attempt.
+     */
+    wifi_disconnect_quietly();
+
+    report_wifi_status(WIFI_STATUS_FAILED, last_failure_reason);
+
+    return ESP_FAIL;
+}
+
 void wifi_connect_ap(const char *ssid, const char *pass)
 {
     esp_netif = esp_netif_create_default_wifi_ap(); // Creates default WIFI STA. In case of any init error this API aborts.
@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdbool.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -37,9 +38,32 @@
 #define ESP32_DISCONNECTED BIT1
 
 #define WIFI_CONNECTION_TIMEOUT_10_SEC 10000
+#define WIFI_DISCONNECT_TIMEOUT_1_SEC 1000
+
+/*
+ * Connection progress of the station interface. These values are reported to the registered status callback
+ * as the WIFI events arrive so that the portal can show the user what is happening.
+ */
+typedef enum
+{
+    WIFI_STATUS_IDLE = 0,     // No connection attempt is running
+    WIFI_STATUS_SCANNING,     // esp_wifi_connect() issued, driver is scanning for the AP
+    WIFI_STATUS_ASSOCIATED,   // Associated with the AP, waiting for the IP address
+    WIFI_STATUS_GOT_IP,       // IP address received, connection is successful
+    WIFI_STATUS_FAILED,       // Connection attempt failed, reason holds the wifi_err_reason_t code
+    WIFI_STATUS_DISCONNECTED, // Station left the AP on request
+
+} WIFI_STATUS_t;
+
+/* Callback type for the connection progress. It is called from the default event loop task so it must not block. */
+typedef void (*wifi_status_cb_t)(WIFI_STATUS_t status, uint8_t reason);
 
 void wifi_init(void);
+void wifi_init_netif(void);
+void wifi_init_driver(void);
+void wifi_register_status_callback(wifi_status_cb_t callback);
 esp_err_t wifi_connect_sta(const char *ssid, const char *pass, int timeout);
+esp_err_t wifi_connect_sta_keep_ap(const char *ssid, const char *pass, int timeout);
 void wifi_connect_ap(const char *ssid, const char *pass);
 void wifi_disconnect(void);
 void wifi_destroy_netif(void);
@@ -0,0 +1,178 @@
+/**
+ * @file boot_graph.c
+ *
+ * @brief Boot task graph source
+ *
+ * This file defines the FreeRTOS part of the dependency aware task graph used for the boot of the ESP32.
+ * One worker task is started on each core. The worker runs the steps pinned to its core in the order of the array
+ * and before every step it waits on the event group until the steps it depends on are done.
+ *
+ * @note A step can only depend on the steps placed before it in the array, this way the workers can never wait on each other in a loop.
+ *
+ * @author agent
+ * @date 19 Oct 2026
+ * @version 1.0
+ *
+ * @see "boot_graph.h" for the structures of the graph.
+ *
+ */
+
+#include "boot_graph.h"
+
+static const char *BOOT_TAG = "BOOT";
+
+/*
+ * This function is the worker task of one core. It waits for the start notification, runs all the steps pinned to the core
+ * on which it is running, sets its exit bit and then deletes itself. xEventGroupSetBits() still reads the event group after
+ * boot_graph_finish() may have returned, so the event group lives in the graph (static allocation) and is never deleted.
+ */
+static void boot_graph_worker(void *arg)
+{
+    BOOT_GRAPH_t *graph = (BOOT_GRAPH_t *)arg;
+    BaseType_t core = xPortGetCoreID();
+
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // Wait until all the workers are created
+
+    for (size_t i = boot_graph_next_step(graph->steps, graph->step_count, core, 0); i < graph->step_count;
+         i = boot_graph_next_step(graph->steps, graph->step_count, core, i + 1))
+    {
+        BOOT_STEP_t *step = &graph->steps[i];
+
+        // Block until all the dependencies of the step are done. The bits are not cleared so other steps can wait on them too.
+        if (step->depends_on != 0)
+        {
+            xEventGroupWaitBits(graph->done_events, step->depends_on, pdFALSE, pdTRUE, portMAX_DELAY);
+        }
+
+        step->start_us = esp_timer_get_time() - graph->start_time_us;
+        step->result = step->run(step->arg);
+        step->end_us = esp_timer_get_time() - graph->start_time_us;
+
+        xEventGroupSetBits(graph->done_events, BOOT_STEP_BIT(i));
+    }
+
+    xEventGroupSetBits(graph->done_events, BOOT_WORKER_EXIT_BIT(core));
+
+    vTaskDelete(NULL);
+}
+
+/*
+ * This function checks the steps, creates the event group and starts one worker task on each core.
+ * The steps of a core which does not exist (single core build) are moved to the core 0.
+ * The workers only start the steps when all of them are created, so a failed creation can be cleaned up completely.
+ * The graph must stay valid for the whole run time of the application (static), the steps until boot_graph_finish() returns.
+ *
+ * @return
+ *   - ESP_OK: the workers are started
+ *   - ESP_ERR_INVALID_ARG: too many steps or a step depends on itself or on a later step
+ *   - ESP_ERR_NO_MEM: a worker task can not be created, nothing is left running
+ */
+esp_err_t boot_graph_start(BOOT_GRAPH_t *graph, BOOT_STEP_t *steps, size_t step_count)
+{
+    if (!boot_graph_steps_are_valid(steps, step_count))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < step_count; i++)
+    {
+        if (steps[i].core < 0 || steps[i].core >= portNUM_PROCESSORS)
+        {
+            steps[i].core = 0;
+        }
+
+        steps[i].result = ESP_OK;
+        steps[i].start_us = 0;
+        steps[i].end_us = 0;
+        steps[i].critical_path_us = 0;
+    }
+
+    graph->steps = steps;
+    graph->step_count = step_count;
+
+    graph->done_events = xEventGroupCreateStatic(&graph->done_events_buffer);
+
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        if (xTaskCreatePinnedToCore(boot_graph_worker, "boot_worker", BOOT_WORKER_STACK_SIZE, graph, BOOT_WORKER_PRIORITY, &graph->workers[core], core) != pdPASS)
+        {
+            // The workers created before are still waiting for the start notification, they can be deleted safely.
+            for (BaseType_t created = 0; created < core; created++)
+            {
+                vTaskDelete(graph->workers[created]);
+            }
+
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    graph->start_time_us = esp_timer_get_time();
+
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        xTaskNotifyGive(graph->workers[core]);
+    }
+
+    return ESP_OK;
+}
+
+/*
+ * This function blocks the calling task until both workers set their exit bit, then all the steps are done.
+ * The event group is not deleted, a worker may still be inside xEventGroupSetBits() of its exit bit.
+ */
+void boot_graph_finish(BOOT_GRAPH_t *graph)
+{
+    EventBits_t exit_bits = 0;
+
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        exit_bits |= BOOT_WORKER_EXIT_BIT(core);
+    }
+
+    xEventGroupWaitBits(graph->done_events, exit_bits, pdFALSE, pdTRUE, portMAX_DELAY);
+}
+
+/*
+ * This function prints the timing of the boot: every step with its critical-path time,
+ * the real boot time against the time on one core, and the chain of steps on the critical path.
+ * boot_graph_finish() must be called before this function.
+ */
+void boot_graph_report(BOOT_GRAPH_t *graph)
+{
+    size_t last_step = boot_graph_calculate_critical_path(graph->steps, graph->step_count);
+
+    for (size_t i = 0; i < graph->step_count; i++)
+    {
+        BOOT_STEP_t *step = &graph->steps[i];
+
+        ESP_LOGI(BOOT_TAG, "%-16s core %d  run %6lld us  start at %6lld us  done at %6lld us  critical path %6lld us  %s",
+                 step->name, step->core, step->end_us - step->start_us, step->start_us, step->end_us, step->critical_path_us, esp_err_to_name(step->result));
+    }
+
+    ESP_LOGI(BOOT_TAG, "boot %lld us, one core would take %lld us, critical path %lld us",
+             boot_graph_total_time_us(graph->steps, graph->step_count), boot_graph_serial_time_us(graph->steps, graph->step_count), graph->steps[last_step].critical_path_us);
+
+    if (!boot_graph_order_is_valid(graph->steps, graph->step_count))
+    {
+        ESP_LOGW(BOOT_TAG, "a step started before its dependencies were done");
+    }
+
+    /*
+     * Walk back from the step with the longest critical path, always taking the dependency with the longest critical path.
+     */
+    size_t step_index = last_step;
+
+    while (true)
+    {
+        ESP_LOGI(BOOT_TAG, "critical path: %s", graph->steps[step_index].name);
+
+        size_t longest_dependency = boot_graph_critical_dependency(graph->steps, step_index);
+
+        if (longest_dependency == step_index)
+        {
+            break;
+        }
+
+        step_index = longest_dependency;
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @file boot_graph.h
+ *
+ * @brief Boot task graph header
+ *
+ * This header file defines a small dependency aware task graph used for the boot of the ESP32.
+ * Every init step is pinned to one core and waits only for the steps it depends on, so the independent steps
+ * (for example the NVS init and the TCP/IP stack init) run at the same time on both cores.
+ * After the boot the graph reports for every step the run time, the start and end time and
+ * the critical-path time so we can see where the boot time goes.
+ *
+ * @author agent
+ * @date 19 Oct 2026
+ * @version 1.0
+ *
+ * @see "boot_graph_core.h" for the steps and the rules of the graph which are also built on the host.
+ *
+ */
+
+#ifndef boot_graph_h
+#define boot_graph_h
+
+#include <stdio.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_timer.h"
+
+#include "boot_graph_core.h"
+
+#define BOOT_WORKER_EXIT_BIT(core) (1UL << (BOOT_GRAPH_MAX_STEPS + (core))) // Set by the worker of the core as its last access to the graph
+
+#define BOOT_WORKER_STACK_SIZE 4096 // Stack size of the worker task of each core
+#define BOOT_WORKER_PRIORITY 5      // Priority of the worker task of each core
+
+/*
+ * This struct is for the whole boot graph.
+ */
+typedef struct
+{
+    BOOT_STEP_t *steps;
+    size_t step_count;
+
+    EventGroupHandle_t done_events;           // One bit per step set when the step is done, and one exit bit per worker
+    StaticEventGroup_t done_events_buffer;    // Memory of done_events, static so a worker can still read it after boot_graph_finish()
+    TaskHandle_t workers[portNUM_PROCESSORS]; // Worker task of each core
+    int64_t start_time_us;                    // esp_timer time when the graph is started
+
+} BOOT_GRAPH_t;
+
+/* This function is for the start the worker tasks which run the steps of the graph */
+esp_err_t boot_graph_start(BOOT_GRAPH_t *graph, BOOT_STEP_t *steps, size_t step_count);
+
+/* This function is for the wait until both workers are done */
+void boot_graph_finish(BOOT_GRAPH_t *graph);
+
+/* This function is for the print the timing of every step and the critical path */
+void boot_graph_report(BOOT_GRAPH_t *graph);
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @file boot_graph_core.c
+ *
+ * @brief Boot task graph core source
+ *
+ * This file defines the functions of the boot task graph which only work on the step array.
+ * The worker tasks on the ESP32 and the host simulation use the same functions, so the host test checks the real rules.
+ *
+ * @author agent
+ * @date 19 Oct 2026
+ * @version 1.0
+ *
+ * @see "boot_graph_core.h" for the structure of the steps.
+ *
+ */
+
+#include "boot_graph_core.h"
+
+/*
+ * A step can only depend on the steps placed before it in the array, this way the workers can never wait on each other in a loop.
+ */
+bool boot_graph_steps_are_valid(const BOOT_STEP_t *steps, size_t step_count)
+{
+    if (step_count == 0 || step_count > BOOT_GRAPH_MAX_STEPS)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < step_count; i++)
+    {
+        // Only the steps placed before this one are allowed as dependency.
+        if (steps[i].depends_on & ~(BOOT_STEP_BIT(i) - 1))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Every core runs its steps in the order of the array.
+ */
+size_t boot_graph_next_step(const BOOT_STEP_t *steps, size_t step_count, int core, size_t from)
+{
+    for (size_t i = from; i < step_count; i++)
+    {
+        if (steps[i].core == core)
+        {
+            return i;
+        }
+    }
+
+    return step_count;
+}
+
+int64_t boot_graph_dependencies_done_us(const BOOT_STEP_t *steps, size_t step_index)
+{
+    int64_t done_us = 0;
+
+    for (size_t dependency = 0; dependency < step_index; dependency++)
+    {
+        if ((steps[step_index].depends_on & BOOT_STEP_BIT(dependency)) && steps[dependency].end_us > done_us)
+        {
+            done_us = steps[dependency].end_us;
+        }
+    }
+
+    return done_us;
+}
+
+size_t boot_graph_critical_dependency(const BOOT_STEP_t *steps, size_t step_index)
+{
+    size_t longest_dependency = step_index;
+
+    for (size_t dependency = 0; dependency < step_index; dependency++)
+    {
+        if ((steps[step_index].depends_on & BOOT_STEP_BIT(dependency)) &&
+            (longest_dependency == step_index || steps[dependency].critical_path_us > steps[longest_dependency].critical_path_us))
+        {
+            longest_dependency = dependency;
+        }
+    }
+
+    return longest_dependency;
+}
+
+/*
+ * The critical-path time of a step is the longest chain of the step durations which ends with this step,
+ * this is the earliest time the step could be done with unlimited cores. The difference to the real end time
+ * shows how long the step was delayed because its core was busy with other steps.
+ * All the steps must be done before this function is called.
+ */
+size_t boot_graph_calculate_critical_path(BOOT_STEP_t *steps, size_t step_count)
+{
+    size_t last_step = 0;
+
+    for (size_t i = 0; i < step_count; i++)
+    {
+        size_t longest_dependency = boot_graph_critical_dependency(steps, i);
+        int64_t longest_dependency_us = (longest_dependency == i) ? 0 : steps[longest_dependency].critical_path_us;
+
+        steps[i].critical_path_us = longest_dependency_us + (steps[i].end_us - steps[i].start_us);
+
+        if (steps[i].critical_path_us > steps[last_step].critical_path_us)
+        {
+            last_step = i;
+        }
+    }
+
+    return last_step;
+}
+
+bool boot_graph_order_is_valid(const BOOT_STEP_t *steps, size_t step_count)
+{
+    for (size_t i = 0; i < step_count; i++)
+    {
+        if (steps[i].start_us < boot_graph_dependencies_done_us(steps, i) || steps[i].end_us < steps[i].start_us)
+        {
+            return false;
+        }
+
+        // The next step of the same core can only start after this one is done.
+        size_t next_step = boot_graph_next_step(steps, step_count, steps[i].core, i + 1);
+
+        if (next_step < step_count && steps[next_step].start_us < steps[i].end_us)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int64_t boot_graph_serial_time_us(const BOOT_STEP_t *steps, size_t step_count)
+{
+    int64_t serial_time_us = 0;
+
+    for (size_t i = 0; i < step_count; i++)
+    {
+        serial_time_us += steps[i].end_us - steps[i].start_us;
+    }
+
+    return serial_time_us;
+}
+
+int64_t boot_graph_total_time_us(const BOOT_STEP_t *steps, size_t step_count)
+{
+    int64_t total_time_us = 0;
+
+    for (size_t i = 0; i < step_count; i++)
+    {
+        if (steps[i].end_us > total_time_us)
+        {
+            total_time_us = steps[i].end_us;
+        }
+    }
+
+    return total_time_us;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file boot_graph_core.h
+ *
+ * @brief Boot task graph core header
+ *
+ * This header file defines the steps of the boot task graph and the functions which work only on the step array:
+ * the check of the dependencies, the order in which a core runs its steps and the critical-path calculation.
+ * It does not use FreeRTOS or ESP-IDF so it can be compiled on the host (see test/host).
+ *
+ * @author agent
+ * @date 19 Oct 2026
+ * @version 1.0
+ *
+ * @see "boot_graph.h" for the FreeRTOS worker tasks which run the steps.
+ *
+ */
+
+#ifndef boot_graph_core_h
+#define boot_graph_core_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define BOOT_STEP_BIT(index) (1UL << (index)) // Bit of the step in the depends_on mask and in the done event group
+
+#define BOOT_GRAPH_MAX_STEPS 22 // Event group has 24 usable bits, 2 are used for the exit of the workers
+
+/*
+ * This struct is for the one init step of the boot.
+ * The steps are stored in an array in the order of the dependencies, a step can only depend on the steps before it.
+ */
+typedef struct
+{
+    const char *name;          // Name of the step used in the report
+    int32_t (*run)(void *arg); // Function of the step, returns esp_err_t
+    void *arg;                 // Argument passed to the function
+    uint32_t depends_on;       // Mask of BOOT_STEP_BIT() of the steps which must be done before
+    int core;                  // Core on which the step runs
+
+    int32_t result;            // Value returned by the function (esp_err_t)
+    int64_t start_us;          // Time when the step is started (from the start of the graph)
+    int64_t end_us;            // Time when the step is done
+    int64_t critical_path_us;  // Longest chain of the step durations ending with this step
+
+} BOOT_STEP_t;
+
+/* This function is for the check the number of steps and that every step only depends on the steps before it */
+bool boot_graph_steps_are_valid(const BOOT_STEP_t *steps, size_t step_count);
+
+/* This function is for the find the next step of the core, starting from the index from. Returns step_count when no step is left */
+size_t boot_graph_next_step(const BOOT_STEP_t *steps, size_t step_count, int core, size_t from);
+
+/* This function is for the get the time when the last dependency of the step is done */
+int64_t boot_graph_dependencies_done_us(const BOOT_STEP_t *steps, size_t step_index);
+
+/* This function is for the fill the critical-path time of every step, returns the index of the step with the longest critical path */
+size_t boot_graph_calculate_critical_path(BOOT_STEP_t *steps, size_t step_count);
+
+/* This function is for the get the dependency with the longest critical path, returns step_index when the step has no dependency */
+size_t boot_graph_critical_dependency(const BOOT_STEP_t *steps, size_t step_index);
+
+/* This function is for the check that no step started before its dependencies and no two steps of one core overlap */
+bool boot_graph_order_is_valid(const BOOT_STEP_t *steps, size_t step_count);
+
+/* This function is for the get the sum of the step durations, the boot time on a single core */
+int64_t boot_graph_serial_time_us(const BOOT_STEP_t *steps, size_t step_count);
+
+/* This function is for the get the end time of the last step, the real boot time */
+int64_t boot_graph_total_time_us(const BOOT_STEP_t *steps, size_t step_count);
+
+#endif
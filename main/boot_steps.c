@@ -0,0 +1,46 @@
+/**
+ * @file boot_steps.c
+ *
+ * @brief Boot steps of the application source
+ *
+ * This file defines the graph of the init steps of the application.
+ * The NVS init and the TCP/IP stack init run at the same time, the credentials are read from the NVS
+ * while the WIFI driver is initialized on the other core, and the association starts as soon as both are ready.
+ *
+ * @author agent
+ * @date 19 Oct 2026
+ * @version 1.0
+ *
+ * @see "boot_steps.h" for the index of the steps.
+ *
+ */
+
+#include <string.h>
+
+#include "boot_steps.h"
+
+void boot_steps_describe(BOOT_STEP_t *steps)
+{
+    memset(steps, 0, sizeof(BOOT_STEP_t) * BOOT_STEP_COUNT);
+
+    steps[BOOT_STEP_NVS_INIT].name = "nvs_init";
+    steps[BOOT_STEP_NVS_INIT].core = 1;
+
+    steps[BOOT_STEP_NETIF_INIT].name = "netif_init";
+    steps[BOOT_STEP_NETIF_INIT].core = 0;
+
+    steps[BOOT_STEP_GPIO_INIT].name = "gpio_init";
+    steps[BOOT_STEP_GPIO_INIT].core = 1;
+
+    steps[BOOT_STEP_WIFI_DRIVER_INIT].name = "wifi_driver_init";
+    steps[BOOT_STEP_WIFI_DRIVER_INIT].depends_on = BOOT_STEP_BIT(BOOT_STEP_NVS_INIT) | BOOT_STEP_BIT(BOOT_STEP_NETIF_INIT);
+    steps[BOOT_STEP_WIFI_DRIVER_INIT].core = 0;
+
+    steps[BOOT_STEP_CREDENTIALS_LOAD].name = "credentials_load";
+    steps[BOOT_STEP_CREDENTIALS_LOAD].depends_on = BOOT_STEP_BIT(BOOT_STEP_NVS_INIT);
+    steps[BOOT_STEP_CREDENTIALS_LOAD].core = 1;
+
+    steps[BOOT_STEP_ASSOCIATION].name = "association";
+    steps[BOOT_STEP_ASSOCIATION].depends_on = BOOT_STEP_BIT(BOOT_STEP_WIFI_DRIVER_INIT) | BOOT_STEP_BIT(BOOT_STEP_CREDENTIALS_LOAD);
+    steps[BOOT_STEP_ASSOCIATION].core = 0;
+}
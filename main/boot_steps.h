@@ -0,0 +1,38 @@
+/**
+ * @file boot_steps.h
+ *
+ * @brief Boot steps of the application header
+ *
+ * This header file defines the init steps of the boot graph used by main.c: their index, name, dependencies and core.
+ * The functions of the steps are set in main.c, this part does not use ESP-IDF so the host simulation (see test/host)
+ * checks the same graph which runs on the ESP32.
+ *
+ * @author agent
+ * @date 19 Oct 2026
+ * @version 1.0
+ *
+ * @see "boot_graph_core.h" for the structure of the steps.
+ *
+ */
+
+#ifndef boot_steps_h
+#define boot_steps_h
+
+#include "boot_graph_core.h"
+
+/* Index of the init steps in the boot graph. A step can only depend on the steps above it. */
+enum
+{
+    BOOT_STEP_NVS_INIT = 0,
+    BOOT_STEP_NETIF_INIT,
+    BOOT_STEP_GPIO_INIT,
+    BOOT_STEP_WIFI_DRIVER_INIT,
+    BOOT_STEP_CREDENTIALS_LOAD,
+    BOOT_STEP_ASSOCIATION,
+    BOOT_STEP_COUNT,
+};
+
+/* This function is for the fill the name, the dependencies and the core of every step, the function and the argument are cleared */
+void boot_steps_describe(BOOT_STEP_t *steps);
+
+#endif
@@ -5,6 +5,7 @@
  *
  * This application code manages Wi-Fi connections on an ESP32 device. It provides the following functionality:
  * - Initializes the ESP32's non-volatile storage (NVS) for storing Wi-Fi credentials.
+ * - Runs the independent init steps (NVS, TCP/IP stack, Wi-Fi driver, GPIO, credential load) on both cores with a small boot graph.
  * - Handles an on-demand portal for configuring Wi-Fi credentials.
  * - Reads stored Wi-Fi credentials from NVS or sets up an access point (AP) and a local web server for configuring credentials if none are found.
  * - Attempts to connect to a Wi-Fi network using the stored credentials (station mode).
@@ -28,6 +29,8 @@
  */
 #include "connect.h"      // This is manually added file for the wifi related functionality
 #include "wifi_manager.h" // This is manullay added file for the WIFI manager functionality
+#include "boot_graph.h"   // This is manually added file for the parallel boot of the init steps
+#include "boot_steps.h"   // This is manually added file for the init steps of the boot graph
 
 /* Uncomment the below line to debug the wifi manager functionality*/
 // #define DEBUG_CODE
@@ -35,19 +38,82 @@
 #define AP_ssid "ESP32_SETUP"   // This SSID used for the setup the AP
 #define AP_password "123456789" // This Password used for the setup the AP
 
-void app_main(void)
+static const char *MAIN_TAG = "MAIN";
+
+static WIFI_CREDENTIALS_t wifi_credentials_read_from_NVS; // Creat the variable for the wifi credentials
+
+/*
+ * The index, dependencies and core of the steps are defined in boot_steps.c (shared with the host simulation), the functions are set in app_main().
+ * The steps and the graph are static because the workers use them until boot_graph_finish() returns.
+ */
+static BOOT_STEP_t boot_steps[BOOT_STEP_COUNT];
+
+static BOOT_GRAPH_t boot_graph;
+
+static esp_err_t boot_nvs_init(void *arg)
 {
     ESP_ERROR_CHECK(nvs_flash_init()); // Initialize the NVS flash used for the WIFI functionality.
+    return ESP_OK;
+}
 
-    wifi_init(); // Initialize the WIFI.
+static esp_err_t boot_netif_init(void *arg)
+{
+    wifi_init_netif(); // Initialize the TCP/IP stack and the event loop, this does not need the NVS.
+    return ESP_OK;
+}
 
-    check_for_on_demand_condition(); // This function is used for the creat the on demand portal for the ESP32
+static esp_err_t boot_gpio_init(void *arg)
+{
+    return check_for_on_demand_condition(); // This function is used for the creat the on demand portal for the ESP32
+}
+
+static esp_err_t boot_wifi_driver_init(void *arg)
+{
+    wifi_init_driver(); // Initialize the WIFI driver.
+    return ESP_OK;
+}
 
-    WIFI_CREDENTIALS_t wifi_credentials_read_from_NVS; // Creat the variable for the wifi credentials
+static esp_err_t boot_credentials_load(void *arg)
+{
+    return read_the_wifi_credentials_from_NVS((WIFI_CREDENTIALS_t *)arg); // Read the credentials of the WIFI from the NVS flash
+}
+
+static esp_err_t boot_association(void *arg)
+{
+    WIFI_CREDENTIALS_t *wifi_credentials = (WIFI_CREDENTIALS_t *)arg;
 
-    // Read the credentials of the WIFI from the NVS flash
-    if (read_the_wifi_credentials_from_NVS(&wifi_credentials_read_from_NVS) != ESP_OK)
+    // Without the credentials the portal is started by app_main() after the boot.
+    if (boot_steps[BOOT_STEP_CREDENTIALS_LOAD].result != ESP_OK)
     {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    return wifi_connect_sta(wifi_credentials->WIFI_SSID, wifi_credentials->WIFI_PASSWORD, WIFI_CONNECTION_TIMEOUT_10_SEC);
+}
+
+void app_main(void)
+{
+    boot_steps_describe(boot_steps);
+
+    boot_steps[BOOT_STEP_NVS_INIT].run = boot_nvs_init;
+    boot_steps[BOOT_STEP_NETIF_INIT].run = boot_netif_init;
+    boot_steps[BOOT_STEP_GPIO_INIT].run = boot_gpio_init;
+    boot_steps[BOOT_STEP_WIFI_DRIVER_INIT].run = boot_wifi_driver_init;
+    boot_steps[BOOT_STEP_CREDENTIALS_LOAD].run = boot_credentials_load;
+    boot_steps[BOOT_STEP_CREDENTIALS_LOAD].arg = &wifi_credentials_read_from_NVS;
+    boot_steps[BOOT_STEP_ASSOCIATION].run = boot_association;
+    boot_steps[BOOT_STEP_ASSOCIATION].arg = &wifi_credentials_read_from_NVS;
+
+    ESP_ERROR_CHECK(boot_graph_start(&boot_graph, boot_steps, BOOT_STEP_COUNT));
+
+    boot_graph_finish(&boot_graph); // Wait until all the steps are done, the association included
+    boot_graph_report(&boot_graph);
+
+    // Check the credentials read from the NVS flash
+    if (boot_steps[BOOT_STEP_CREDENTIALS_LOAD].result != ESP_OK)
+    {
+        ESP_LOGI(MAIN_TAG, "no credentials in the NVS, starting the portal");
+
         /*
          * When the no credentials found in the NVS turn on the WIFI in access point mode so that
          * user can set the wifi over the local web server.
@@ -57,9 +123,7 @@ void app_main(void)
         init_web_server(); // Initialize the server so user can set the wifi parameters over the WEB
     }
 
-    wifi_connect_sta(wifi_credentials_read_from_NVS.WIFI_SSID, wifi_credentials_read_from_NVS.WIFI_PASSWORD, WIFI_CONNECTION_TIMEOUT_10_SEC);
-
 #ifdef DEBUG_CODE
     printf(" SSID is - %s \n SSID size of the string is %d \n PASSWORD - %s \n Password size of the string is %d \n", wifi_credentials_read_from_NVS.WIFI_SSID, strlen(wifi_credentials_read_from_NVS.WIFI_SSID), wifi_credentials_read_from_NVS.WIFI_PASSWORD, strlen(wifi_credentials_read_from_NVS.WIFI_PASSWORD));
 #endif
-}
\ No newline at end of file
+}
@@ -25,6 +25,23 @@
 
 #include "wifi_manager.h"
 
+#include "lwip/sockets.h"
+
+static const char *PORTAL_TAG = "PORTAL";
+
+static httpd_handle_t web_server = NULL; // Handler of the portal web server
+
+static QueueHandle_t provisioning_queue = NULL; // Credentials submitted from the portal, waiting for the connection attempt
+
+/*
+ * Socket descriptors of the portal pages listening the connection progress. -1 means the slot is free.
+ * This list is only touched from the server task (URI handler, close function and queued work) so it need no lock.
+ */
+static int ws_status_clients[WS_MAX_STATUS_CLIENTS];
+
+/* Last connection progress packed as (status << 8 | reason), replayed to a portal page when it connect late */
+static volatile uint16_t last_wifi_status = WIFI_STATUS_IDLE << 8;
+
 /*
  * This function effectively stores the WiFi credentials in the NVS storage under the "my_credentials" namespace with the key "Credentials."
  * Storing these credentials in NVS allows for persistence, so they can be retrieved and used even after a power cycle or reboot of the ESP32 device.
@@ -144,10 +161,138 @@ esp_err_t save_wifi_credentials_url(httpd_req_t *req)
 
     save_the_wifi_credentials_into_NVS(&wifi_credentials_received_from_WEB_page);
 
+    /*
+     * Hand over the credentials to the provisioning loop in init_web_server(). The handler must not block the server task,
+     * so the queue is overwritten in case of the previous credentials are not taken yet.
+     */
+    xQueueOverwrite(provisioning_queue, &wifi_credentials_received_from_WEB_page);
+
     httpd_resp_sendstr(req, STATIC_SAVE_PAGE);
     return ESP_OK;
 }
 
+/*
+ * This function runs in the server task (queued by the httpd_queue_work) and send the last connection progress to all the portal pages.
+ * The WebSocket sockets are non-blocking (see wifi_status_ws_url()), so a stalled page makes the send fail at once instead of
+ * blocking the server task for the send_wait_timeout.
+ */
+static void ws_status_broadcast(void *arg)
+{
+    uint16_t packed_status = (uint16_t)(uintptr_t)arg;
+
+    WIFI_STATUS_FRAME_t status_frame = {
+        .status = packed_status >> 8,
+        .reason = packed_status & 0xFF};
+
+    httpd_ws_frame_t ws_frame;
+    memset(&ws_frame, 0, sizeof(httpd_ws_frame_t));
+    ws_frame.type = HTTPD_WS_TYPE_BINARY;
+    ws_frame.payload = (uint8_t *)&status_frame;
+    ws_frame.len = sizeof(WIFI_STATUS_FRAME_t);
+
+    for (int i = 0; i < WS_MAX_STATUS_CLIENTS; i++)
+    {
+        if (ws_status_clients[i] < 0)
+        {
+            continue;
+        }
+
+        // Close the socket if the send fail, the page reconnects and gets the last status replayed.
+        if (httpd_ws_send_frame_async(web_server, ws_status_clients[i], &ws_frame) != ESP_OK)
+        {
+            httpd_sess_trigger_close(web_server, ws_status_clients[i]);
+            ws_status_clients[i] = -1;
+        }
+    }
+}
+
+/*
+ * This function is registered into the WIFI component and called from the event loop task for every connection progress.
+ * The status is packed into the work argument so no memory is allocated and the event loop is not blocked.
+ */
+static void wifi_status_changed(WIFI_STATUS_t status, uint8_t reason)
+{
+    last_wifi_status = (uint16_t)((status << 8) | reason);
+
+    if (web_server != NULL)
+    {
+        httpd_queue_work(web_server, ws_status_broadcast, (void *)(uintptr_t)last_wifi_status);
+    }
+}
+
+/*
+ * This function is the handler of the WebSocket URL. The handshake registers the portal page as a listener of the connection progress
+ * and replays the last status, so a page opened after the connection attempt started still shows the correct state.
+ * Frames received from the page are not used and are only read out of the socket.
+ */
+esp_err_t wifi_status_ws_url(httpd_req_t *req)
+{
+    int socket_fd = httpd_req_to_sockfd(req);
+
+    if (req->method == HTTP_GET)
+    {
+#ifdef DEBUG_CODE
+        ESP_LOGI(TAG, "WebSocket handshake done, fd %d", socket_fd);
+#endif
+
+        int free_slot = -1;
+
+        for (int i = 0; i < WS_MAX_STATUS_CLIENTS; i++)
+        {
+            // The fd is already listening, only replay the status.
+            if (ws_status_clients[i] == socket_fd)
+            {
+                return httpd_queue_work(req->handle, ws_status_broadcast, (void *)(uintptr_t)last_wifi_status);
+            }
+
+            if (ws_status_clients[i] < 0 && free_slot < 0)
+            {
+                free_slot = i;
+            }
+        }
+
+        // Close the WebSocket if the list is full, the page shows the closed link instead of waiting for updates forever.
+        if (free_slot < 0)
+        {
+            ESP_LOGW(PORTAL_TAG, "No free slot for the WebSocket fd %d, max %d pages", socket_fd, WS_MAX_STATUS_CLIENTS);
+            return ESP_FAIL;
+        }
+
+        ws_status_clients[free_slot] = socket_fd;
+
+        // Only the small status frames are sent on this socket after the handshake, a full send buffer must fail instead of blocking.
+        fcntl(socket_fd, F_SETFL, fcntl(socket_fd, F_GETFL, 0) | O_NONBLOCK);
+
+        return httpd_queue_work(req->handle, ws_status_broadcast, (void *)(uintptr_t)last_wifi_status);
+    }
+
+    uint8_t frame_buffer[sizeof(WIFI_STATUS_FRAME_t)];
+
+    httpd_ws_frame_t ws_frame;
+    memset(&ws_frame, 0, sizeof(httpd_ws_frame_t));
+    ws_frame.payload = frame_buffer;
+
+    // Read the frame to keep the socket clean, larger frames are not expected from the portal page and close the connection.
+    return httpd_ws_recv_frame(req, &ws_frame, sizeof(frame_buffer));
+}
+
+/*
+ * This function is called by the server when a socket is closed. It remove the socket from the list of the WebSocket listeners
+ * so the fd is not used by the broadcast after it is reused for a new HTTP connection.
+ */
+static void web_server_close_socket(httpd_handle_t hd, int socket_fd)
+{
+    for (int i = 0; i < WS_MAX_STATUS_CLIENTS; i++)
+    {
+        if (ws_status_clients[i] == socket_fd)
+        {
+            ws_status_clients[i] = -1;
+        }
+    }
+
+    close(socket_fd);
+}
+
 /*
  * This function initializes a GPIO pin as an input with a pull-up resistor enabled and pull-down resistor disabled.
  * The pin's state will be checked periodically to detect changes, and no interrupts will be generated when the state changes.
@@ -179,16 +324,29 @@ esp_err_t check_for_on_demand_condition(void)
 
 /*
  * Function is responsible for initializing and starting a web server on an ESP32. It sets up the server configuration, registers URI handlers for specific URLs, and then starts the server.
- * This function sets up a basic web server on the ESP32 with two URL handlers—one for serving a home page and another for saving WiFi credentials.
- * It then starts the server, and the server will continue running as long as the program is executing.
+ * This function sets up a basic web server on the ESP32 with three URL handlers—one for serving a home page, one for saving WiFi credentials
+ * and a WebSocket which push the connection progress to the portal page.
+ * It then waits for the credentials submitted from the portal and tries to connect with them while the AP stay up, so the user can see the result.
  */
 void init_web_server(void)
 {
     httpd_handle_t server = NULL;                   // Declination of the server handler.
     httpd_config_t config = HTTPD_DEFAULT_CONFIG(); // Declination of the server configuration.
 
+    config.close_fn = web_server_close_socket; // Track the closed sockets to keep the WebSocket listener list valid
+
+    provisioning_queue = xQueueCreate(1, sizeof(WIFI_CREDENTIALS_t)); // Only the latest submitted credentials are kept
+
+    for (int i = 0; i < WS_MAX_STATUS_CLIENTS; i++)
+    {
+        ws_status_clients[i] = -1; // No portal page is listening yet
+    }
+
     ESP_ERROR_CHECK(httpd_start(&server, &config)); // Start the server wi the default settting
 
+    web_server = server;
+    wifi_register_status_callback(wifi_status_changed);
+
     /* This URL is for the home page */
     httpd_uri_t set_wifi_credentials_url_handler = {
         .uri = "/",
@@ -203,8 +361,21 @@ void init_web_server(void)
         .handler = save_wifi_credentials_url};
     httpd_register_uri_handler(server, &save_wifi_credentials_url_handler);
 
+    /* This URL is for the WebSocket which push the connection progress */
+    httpd_uri_t wifi_status_ws_url_handler = {
+        .uri = WS_STATUS_URI,
+        .method = HTTP_GET,
+        .handler = wifi_status_ws_url,
+        .is_websocket = true};
+    httpd_register_uri_handler(server, &wifi_status_ws_url_handler);
+
+    WIFI_CREDENTIALS_t wifi_credentials_received_from_WEB_page;
+
     while (true)
     {
-        vTaskDelay(100 / portTICK_PERIOD_MS);
+        if (xQueueReceive(provisioning_queue, &wifi_credentials_received_from_WEB_page, portMAX_DELAY) == pdTRUE)
+        {
+            wifi_connect_sta_keep_ap(wifi_credentials_received_from_WEB_page.WIFI_SSID, wifi_credentials_received_from_WEB_page.WIFI_PASSWORD, PROVISIONING_TIMEOUT);
+        }
     }
 }
\ No newline at end of file
@@ -43,13 +43,24 @@
 
 #include "esp_netif.h"
 
+#include "connect.h"
+
 #define ON_DEMAND_SWITCH_GPIO GPIO_NUM_0 // This pin is used for the trigger the wifi manager portal
 
 #define AP_SSID "ESP32"    // Default SSID of the ESP32 while operating into AP mode
 #define AP_PASS "12345678" // Default PASS of the ESP32 while operating into AP mode
 
 #define STATIC_HOME_PAGE "<!DOCTYPE html><html><body><h2>Set WiFi Credentials</h2><form action='/save_credentials'> <label for='ssid'>SSID:</label><br> <input type='text' id='ssid' name='ssid' required><br> <label for='password'>Password:</label><br> <input type='password' id='password' name='password' required><br><br> <input type='submit' value='Submit'> </form>  </body> </html>"
-#define STATIC_SAVE_PAGE "<!DOCTYPE html><html><body><h2>WiFi Credentials saved</h2> </body> </html>"
+/*
+ * The save page keeps the WebSocket open and reconnects with a backoff (0.5 s doubling up to 5 s) when the link is lost.
+ * The phone is dropped from the AP when the AP follows the channel of the home router (see wifi_connect_sta_keep_ap()),
+ * after the reconnect the server replays the last status so the page still shows the GOT IP or the failure.
+ */
+#define STATIC_SAVE_PAGE "<!DOCTYPE html><html><body><h2>WiFi Credentials saved</h2><p id='s'>Waiting for the status...</p><p id='l'></p><script>var n=['Idle','Scanning...','Associated, waiting for the IP...','Connected (GOT IP)','Failed','Disconnected'];var r={2:'AUTH_EXPIRE',8:'ASSOC_LEAVE',15:'4WAY_HANDSHAKE_TIMEOUT',201:'NO_AP_FOUND',202:'AUTH_FAIL',203:'ASSOC_FAIL',204:'HANDSHAKE_TIMEOUT',205:'CONNECTION_FAIL'};var b=500;function c(){var w=new WebSocket('ws://'+location.host+'/ws');w.binaryType='arraybuffer';w.onopen=function(){b=500;document.getElementById('l').textContent='';};w.onmessage=function(e){var d=new Uint8Array(e.data);var t=n[d[0]]||'?';if(d[1])t+=' - '+(r[d[1]]||('reason '+d[1]));document.getElementById('s').textContent=t;};w.onclose=function(){document.getElementById('l').textContent='Status link lost, reconnecting...';setTimeout(c,b);b=Math.min(2*b,5000);};}c();</script></body></html>"
+
+#define WS_STATUS_URI "/ws"        // WebSocket URL used for the push the connection progress to the portal page
+#define WS_MAX_STATUS_CLIENTS 4    // Max number of the portal pages which can listen the connection progress
+#define PROVISIONING_TIMEOUT 15000 // Time out for the connection attempt started from the portal
 
 #ifdef DEBUG_CODE
 static const char *TAG = "SERVER";
@@ -63,6 +74,17 @@ typedef struct
 
 } WIFI_CREDENTIALS_t;
 
+/*
+ * Fixed size WebSocket frame used for the push the connection progress to the portal page.
+ * status is the WIFI_STATUS_t value and reason is the wifi_err_reason_t code (0 when not a failure).
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t status;
+    uint8_t reason;
+
+} WIFI_STATUS_FRAME_t;
+
 /*
  * This struct is used as the global variable to store all parameter used for the WIFI
  */
@@ -86,6 +108,9 @@ esp_err_t set_wifi_credentials_url(httpd_req_t *req);
 /* This fuction is handler function for the WIFI credentials save */
 esp_err_t save_wifi_credentials_url(httpd_req_t *req);
 
+/* This fuction is handler function for the WebSocket which push the connection progress */
+esp_err_t wifi_status_ws_url(httpd_req_t *req);
+
 /* This function is for the checking the on demand wifi switch. */
 esp_err_t check_for_on_demand_condition(void);
 
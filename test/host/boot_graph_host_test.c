@@ -0,0 +1,209 @@
+/**
+ * @file boot_graph_host_test.c
+ *
+ * @brief Host simulation of the boot task graph
+ *
+ * This file simulates the boot graph of main.c (boot_steps.c) with injected step durations. Every core runs its steps in the order of the array
+ * and a step starts when its core is free and its dependencies are done, the same rule as the worker tasks on the ESP32.
+ * The test checks the dependency order, the critical-path time of every step and that the boot on two cores is faster than on one core.
+ *
+ * @author agent
+ * @date 19 Oct 2026
+ * @version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "boot_graph_core.h"
+#include "boot_steps.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                         \
+    do                                                                           \
+    {                                                                            \
+        if (!(condition))                                                        \
+        {                                                                        \
+            printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                          \
+        }                                                                        \
+    } while (0)
+
+/* Injected duration of every step in us */
+static const int64_t step_durations_us[BOOT_STEP_COUNT] = {
+    [BOOT_STEP_NVS_INIT] = 30000,
+    [BOOT_STEP_NETIF_INIT] = 5000,
+    [BOOT_STEP_GPIO_INIT] = 1000,
+    [BOOT_STEP_WIFI_DRIVER_INIT] = 60000,
+    [BOOT_STEP_CREDENTIALS_LOAD] = 4000,
+    [BOOT_STEP_ASSOCIATION] = 200000,
+};
+
+/*
+ * Run the steps on core_count simulated cores. The steps of a core which does not exist are moved to the core 0 like boot_graph_start().
+ * The array is walked in order, which is valid because a step only depends on the steps before it.
+ */
+static void simulate_boot(BOOT_STEP_t *steps, size_t step_count, int core_count)
+{
+    int64_t core_free_us[2] = {0, 0};
+
+    for (size_t i = 0; i < step_count; i++)
+    {
+        if (steps[i].core < 0 || steps[i].core >= core_count)
+        {
+            steps[i].core = 0;
+        }
+    }
+
+    for (size_t i = 0; i < step_count; i++)
+    {
+        int64_t dependencies_done_us = boot_graph_dependencies_done_us(steps, i);
+        int64_t start_us = core_free_us[steps[i].core];
+
+        if (dependencies_done_us > start_us)
+        {
+            start_us = dependencies_done_us;
+        }
+
+        steps[i].start_us = start_us;
+        steps[i].end_us = start_us + step_durations_us[i];
+        core_free_us[steps[i].core] = steps[i].end_us;
+    }
+}
+
+static void test_dual_core_boot(void)
+{
+    BOOT_STEP_t steps[BOOT_STEP_COUNT];
+    boot_steps_describe(steps); // The steps which run on the ESP32, only the durations are injected
+
+    CHECK(boot_graph_steps_are_valid(steps, BOOT_STEP_COUNT));
+
+    simulate_boot(steps, BOOT_STEP_COUNT, 2);
+
+    // Every step starts after all of its dependencies are done.
+    for (size_t i = 0; i < BOOT_STEP_COUNT; i++)
+    {
+        for (size_t dependency = 0; dependency < i; dependency++)
+        {
+            if (steps[i].depends_on & BOOT_STEP_BIT(dependency))
+            {
+                CHECK(steps[i].start_us >= steps[dependency].end_us);
+            }
+        }
+    }
+    CHECK(boot_graph_order_is_valid(steps, BOOT_STEP_COUNT));
+
+    // The NVS init and the TCP/IP stack init overlap, the association starts as soon as the driver is ready.
+    CHECK(steps[BOOT_STEP_NETIF_INIT].start_us < steps[BOOT_STEP_NVS_INIT].end_us);
+    CHECK(steps[BOOT_STEP_ASSOCIATION].start_us == steps[BOOT_STEP_WIFI_DRIVER_INIT].end_us);
+
+    size_t last_step = boot_graph_calculate_critical_path(steps, BOOT_STEP_COUNT);
+
+    CHECK(steps[BOOT_STEP_NVS_INIT].critical_path_us == 30000);
+    CHECK(steps[BOOT_STEP_NETIF_INIT].critical_path_us == 5000);
+    CHECK(steps[BOOT_STEP_GPIO_INIT].critical_path_us == 1000);
+    CHECK(steps[BOOT_STEP_WIFI_DRIVER_INIT].critical_path_us == 90000);
+    CHECK(steps[BOOT_STEP_CREDENTIALS_LOAD].critical_path_us == 34000);
+    CHECK(steps[BOOT_STEP_ASSOCIATION].critical_path_us == 290000);
+
+    // Critical path: association <- wifi_driver_init <- nvs_init
+    CHECK(last_step == BOOT_STEP_ASSOCIATION);
+    CHECK(boot_graph_critical_dependency(steps, BOOT_STEP_ASSOCIATION) == BOOT_STEP_WIFI_DRIVER_INIT);
+    CHECK(boot_graph_critical_dependency(steps, BOOT_STEP_WIFI_DRIVER_INIT) == BOOT_STEP_NVS_INIT);
+    CHECK(boot_graph_critical_dependency(steps, BOOT_STEP_NVS_INIT) == BOOT_STEP_NVS_INIT);
+
+    // Two cores reach the critical path, which is shorter than the serial boot.
+    int64_t total_us = boot_graph_total_time_us(steps, BOOT_STEP_COUNT);
+    int64_t serial_us = boot_graph_serial_time_us(steps, BOOT_STEP_COUNT);
+
+    CHECK(total_us == steps[last_step].critical_path_us);
+    CHECK(serial_us == 300000);
+    CHECK(total_us < serial_us);
+
+    // The association starts before the init steps would be done on one core.
+    int64_t serial_init_us = serial_us - step_durations_us[BOOT_STEP_ASSOCIATION];
+    CHECK(steps[BOOT_STEP_ASSOCIATION].start_us < serial_init_us);
+
+    printf("dual core: boot %lld us, serial %lld us, speedup %.2f, association starts at %lld us instead of %lld us\n", (long long)total_us, (long long)serial_us,
+           (double)serial_us / (double)total_us, (long long)steps[BOOT_STEP_ASSOCIATION].start_us, (long long)serial_init_us);
+}
+
+static void test_single_core_boot(void)
+{
+    BOOT_STEP_t steps[BOOT_STEP_COUNT];
+    boot_steps_describe(steps); // The steps which run on the ESP32, only the durations are injected
+
+    simulate_boot(steps, BOOT_STEP_COUNT, 1);
+
+    CHECK(boot_graph_order_is_valid(steps, BOOT_STEP_COUNT));
+
+    // On one core the boot takes the sum of all the steps.
+    CHECK(boot_graph_total_time_us(steps, BOOT_STEP_COUNT) == boot_graph_serial_time_us(steps, BOOT_STEP_COUNT));
+}
+
+static void test_order_violation_detected(void)
+{
+    BOOT_STEP_t steps[BOOT_STEP_COUNT];
+    boot_steps_describe(steps); // The steps which run on the ESP32, only the durations are injected
+
+    simulate_boot(steps, BOOT_STEP_COUNT, 2);
+
+    // The credentials are read before the NVS init is done.
+    steps[BOOT_STEP_CREDENTIALS_LOAD].start_us = steps[BOOT_STEP_NVS_INIT].end_us - 1;
+    CHECK(!boot_graph_order_is_valid(steps, BOOT_STEP_COUNT));
+
+    // Two steps of the core 1 overlap.
+    simulate_boot(steps, BOOT_STEP_COUNT, 2);
+    steps[BOOT_STEP_GPIO_INIT].end_us = steps[BOOT_STEP_CREDENTIALS_LOAD].start_us + 1;
+    CHECK(!boot_graph_order_is_valid(steps, BOOT_STEP_COUNT));
+}
+
+static void test_invalid_steps_rejected(void)
+{
+    BOOT_STEP_t steps[BOOT_GRAPH_MAX_STEPS + 1];
+    memset(steps, 0, sizeof(steps));
+
+    CHECK(boot_graph_steps_are_valid(steps, BOOT_GRAPH_MAX_STEPS));
+    CHECK(!boot_graph_steps_are_valid(steps, 0));
+    CHECK(!boot_graph_steps_are_valid(steps, BOOT_GRAPH_MAX_STEPS + 1));
+
+    steps[1].depends_on = BOOT_STEP_BIT(1); // Depends on itself
+    CHECK(!boot_graph_steps_are_valid(steps, 3));
+
+    steps[1].depends_on = BOOT_STEP_BIT(2); // Depends on a later step
+    CHECK(!boot_graph_steps_are_valid(steps, 3));
+
+    steps[1].depends_on = BOOT_STEP_BIT(0);
+    CHECK(boot_graph_steps_are_valid(steps, 3));
+}
+
+static void test_next_step_of_core(void)
+{
+    BOOT_STEP_t steps[BOOT_STEP_COUNT];
+    boot_steps_describe(steps); // The steps which run on the ESP32, only the durations are injected
+
+    CHECK(boot_graph_next_step(steps, BOOT_STEP_COUNT, 0, 0) == BOOT_STEP_NETIF_INIT);
+    CHECK(boot_graph_next_step(steps, BOOT_STEP_COUNT, 0, BOOT_STEP_NETIF_INIT + 1) == BOOT_STEP_WIFI_DRIVER_INIT);
+    CHECK(boot_graph_next_step(steps, BOOT_STEP_COUNT, 1, BOOT_STEP_GPIO_INIT + 1) == BOOT_STEP_CREDENTIALS_LOAD);
+    CHECK(boot_graph_next_step(steps, BOOT_STEP_COUNT, 1, BOOT_STEP_CREDENTIALS_LOAD + 1) == BOOT_STEP_COUNT);
+}
+
+int main(void)
+{
+    test_dual_core_boot();
+    test_single_core_boot();
+    test_order_violation_detected();
+    test_invalid_steps_rejected();
+    test_next_step_of_core();
+
+    if (failures != 0)
+    {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+
+    printf("all checks passed\n");
+    return 0;
+}